@@ -19,6 +19,20 @@ extern "C" SEXP _lobstr_obj_addrs_(SEXP x) {
     return cpp11::as_sexp(obj_addrs_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x)));
   END_CPP11
 }
+// cst.cpp
+std::string cst_path_(SEXP calls, cpp11::integers parents, int n);
+extern "C" SEXP _lobstr_cst_path_(SEXP calls, SEXP parents, SEXP n) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(cst_path_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(calls), cpp11::as_cpp<cpp11::decay_t<cpp11::integers>>(parents), cpp11::as_cpp<cpp11::decay_t<int>>(n)));
+  END_CPP11
+}
+// dups.cpp
+cpp11::list obj_dups_(cpp11::list objects, SEXP base_env, int sizeof_vector, double min_size);
+extern "C" SEXP _lobstr_obj_dups_(SEXP objects, SEXP base_env, SEXP sizeof_vector, SEXP min_size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(obj_dups_(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(objects), cpp11::as_cpp<cpp11::decay_t<SEXP>>(base_env), cpp11::as_cpp<cpp11::decay_t<int>>(sizeof_vector), cpp11::as_cpp<cpp11::decay_t<double>>(min_size)));
+  END_CPP11
+}
 // inspect.cpp
 cpp11::list obj_inspect_(SEXP x, double max_depth, bool expand_char, bool expand_altrep, bool expand_env, bool expand_call, bool expand_bytecode);
 extern "C" SEXP _lobstr_obj_inspect_(SEXP x, SEXP max_depth, SEXP expand_char, SEXP expand_altrep, SEXP expand_env, SEXP expand_call, SEXP expand_bytecode) {
@@ -26,6 +40,27 @@ extern "C" SEXP _lobstr_obj_inspect_(SEXP x, SEXP max_depth, SEXP expand_char, S
     return cpp11::as_sexp(obj_inspect_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<double>>(max_depth), cpp11::as_cpp<cpp11::decay_t<bool>>(expand_char), cpp11::as_cpp<cpp11::decay_t<bool>>(expand_altrep), cpp11::as_cpp<cpp11::decay_t<bool>>(expand_env), cpp11::as_cpp<cpp11::decay_t<bool>>(expand_call), cpp11::as_cpp<cpp11::decay_t<bool>>(expand_bytecode)));
   END_CPP11
 }
+// paths.cpp
+cpp11::list obj_paths_(cpp11::list roots, std::string addr, int max_paths, double max_nodes, double max_time);
+extern "C" SEXP _lobstr_obj_paths_(SEXP roots, SEXP addr, SEXP max_paths, SEXP max_nodes, SEXP max_time) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(obj_paths_(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(roots), cpp11::as_cpp<cpp11::decay_t<std::string>>(addr), cpp11::as_cpp<cpp11::decay_t<int>>(max_paths), cpp11::as_cpp<cpp11::decay_t<double>>(max_nodes), cpp11::as_cpp<cpp11::decay_t<double>>(max_time)));
+  END_CPP11
+}
+// serialize.cpp
+double obj_serialized_size_(SEXP x, int version);
+extern "C" SEXP _lobstr_obj_serialized_size_(SEXP x, SEXP version) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(obj_serialized_size_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<int>>(version)));
+  END_CPP11
+}
+// serialize.cpp
+SEXP obj_serialized_sample_(SEXP x, int version, double total, double sample_size);
+extern "C" SEXP _lobstr_obj_serialized_sample_(SEXP x, SEXP version, SEXP total, SEXP sample_size) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(obj_serialized_sample_(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<int>>(version), cpp11::as_cpp<cpp11::decay_t<double>>(total), cpp11::as_cpp<cpp11::decay_t<double>>(sample_size)));
+  END_CPP11
+}
 // size.cpp
 double v_size(double n, int element_size);
 extern "C" SEXP _lobstr_v_size(SEXP n, SEXP element_size) {
@@ -47,15 +82,28 @@ extern "C" SEXP _lobstr_obj_csize_(SEXP objects, SEXP base_env, SEXP sizeof_node
     return cpp11::as_sexp(obj_csize_(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(objects), cpp11::as_cpp<cpp11::decay_t<cpp11::environment>>(base_env), cpp11::as_cpp<cpp11::decay_t<int>>(sizeof_node), cpp11::as_cpp<cpp11::decay_t<int>>(sizeof_vector)));
   END_CPP11
 }
+// size.cpp
+cpp11::list obj_size_classes_(cpp11::list objects, cpp11::environment base_env, int sizeof_node, int sizeof_vector);
+extern "C" SEXP _lobstr_obj_size_classes_(SEXP objects, SEXP base_env, SEXP sizeof_node, SEXP sizeof_vector) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(obj_size_classes_(cpp11::as_cpp<cpp11::decay_t<cpp11::list>>(objects), cpp11::as_cpp<cpp11::decay_t<cpp11::environment>>(base_env), cpp11::as_cpp<cpp11::decay_t<int>>(sizeof_node), cpp11::as_cpp<cpp11::decay_t<int>>(sizeof_vector)));
+  END_CPP11
+}
 
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
-    {"_lobstr_obj_addr_",    (DL_FUNC) &_lobstr_obj_addr_,    2},
-    {"_lobstr_obj_addrs_",   (DL_FUNC) &_lobstr_obj_addrs_,   1},
-    {"_lobstr_obj_csize_",   (DL_FUNC) &_lobstr_obj_csize_,   4},
-    {"_lobstr_obj_inspect_", (DL_FUNC) &_lobstr_obj_inspect_, 7},
-    {"_lobstr_obj_size_",    (DL_FUNC) &_lobstr_obj_size_,    4},
-    {"_lobstr_v_size",       (DL_FUNC) &_lobstr_v_size,       2},
+    {"_lobstr_cst_path_",              (DL_FUNC) &_lobstr_cst_path_,              3},
+    {"_lobstr_obj_addr_",              (DL_FUNC) &_lobstr_obj_addr_,              2},
+    {"_lobstr_obj_addrs_",             (DL_FUNC) &_lobstr_obj_addrs_,             1},
+    {"_lobstr_obj_csize_",             (DL_FUNC) &_lobstr_obj_csize_,             4},
+    {"_lobstr_obj_dups_",              (DL_FUNC) &_lobstr_obj_dups_,              4},
+    {"_lobstr_obj_inspect_",           (DL_FUNC) &_lobstr_obj_inspect_,           7},
+    {"_lobstr_obj_paths_",             (DL_FUNC) &_lobstr_obj_paths_,             5},
+    {"_lobstr_obj_serialized_sample_", (DL_FUNC) &_lobstr_obj_serialized_sample_, 4},
+    {"_lobstr_obj_serialized_size_",   (DL_FUNC) &_lobstr_obj_serialized_size_,   2},
+    {"_lobstr_obj_size_",              (DL_FUNC) &_lobstr_obj_size_,              4},
+    {"_lobstr_obj_size_classes_",      (DL_FUNC) &_lobstr_obj_size_classes_,      4},
+    {"_lobstr_v_size",                 (DL_FUNC) &_lobstr_v_size,                 2},
     {NULL, NULL, 0}
 };
 }
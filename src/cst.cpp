@@ -0,0 +1,75 @@
+#include <cpp11/integers.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "utils.h"
+
+// Cheap name for the function called by `call`: only looks at the head of
+// the call, so it never needs to evaluate or deparse anything
+std::string call_name(SEXP call) {
+  if (TYPEOF(call) != LANGSXP) {
+    return "<unknown>";
+  }
+
+  SEXP head = CAR(call);
+  if (TYPEOF(head) == SYMSXP) {
+    return CHAR(PRINTNAME(head));
+  }
+
+  // pkg::fun and pkg:::fun
+  if (TYPEOF(head) == LANGSXP && sxp_length(head) == 3) {
+    SEXP op = CAR(head);
+    SEXP pkg = CADR(head);
+    SEXP fun = CADDR(head);
+    if ((op == R_DoubleColonSymbol || op == R_TripleColonSymbol) &&
+        TYPEOF(pkg) == SYMSXP && TYPEOF(fun) == SYMSXP) {
+      return std::string(CHAR(PRINTNAME(pkg))) + "::" + CHAR(PRINTNAME(fun));
+    }
+  }
+
+  return "<anonymous>";
+}
+
+// Follows `parents` up from frame `n` and returns the names of the functions
+// along the way, outermost first, as a single string that can be tabulated.
+// Calls from the top level have no frames, so they get a placeholder name.
+[[cpp11::register]]
+std::string cst_path_(SEXP calls, cpp11::integers parents, int n) {
+  std::vector<SEXP> frames;
+  if (TYPEOF(calls) == VECSXP) {
+    for (R_xlen_t i = 0; i < XLENGTH(calls); ++i) {
+      frames.push_back(VECTOR_ELT(calls, i));
+    }
+  } else {
+    for (SEXP cons = calls; is_linked_list(cons); cons = CDR(cons)) {
+      frames.push_back(CAR(cons));
+    }
+  }
+
+  std::vector<std::string> names;
+  int i = std::min(n, (int) std::min((R_xlen_t) frames.size(), parents.size()));
+  while (i > 0) {
+    names.push_back(call_name(frames[i - 1]));
+
+    // Parents always precede their children; anything else would loop
+    int parent = parents[i - 1];
+    if (parent >= i) {
+      break;
+    }
+    i = parent;
+  }
+
+  if (names.empty()) {
+    return "<top level>";
+  }
+
+  std::string out;
+  for (std::vector<std::string>::reverse_iterator it = names.rbegin(); it != names.rend(); ++it) {
+    if (!out.empty()) {
+      out += " > ";
+    }
+    out += *it;
+  }
+
+  return out;
+}
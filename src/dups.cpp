@@ -0,0 +1,274 @@
+#include <cpp11/doubles.hpp>
+#include <cpp11/integers.hpp>
+#include <cpp11/list.hpp>
+#include <cpp11/named_arg.hpp>
+#include <cpp11/protect.hpp>
+#include <cpp11/strings.hpp>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "edges.h"
+
+double v_size(double n, int element_size);
+
+// Vectors whose contents can be compared byte for byte. ALTREP vectors are
+// excluded because reading their contents could materialise them; see
+// `is_altrep_internal()` for which of their internals are compared instead.
+static inline
+bool is_payload_vector(SEXP x) {
+  switch (TYPEOF(x)) {
+  case LGLSXP:
+  case INTSXP:
+  case REALSXP:
+  case CPLXSXP:
+  case RAWSXP:
+  case STRSXP:
+    return !is_altrep(x) && XLENGTH(x) > 0;
+  default:
+    return false;
+  }
+}
+
+static inline
+int element_size(SEXP x) {
+  switch (TYPEOF(x)) {
+  case LGLSXP:
+  case INTSXP:  return sizeof(int);
+  case REALSXP: return sizeof(double);
+  case CPLXSXP: return sizeof(Rcomplex);
+  case RAWSXP:  return 1;
+  default:      return sizeof(SEXP);
+  }
+}
+
+static inline
+const void* payload(SEXP x) {
+  switch (TYPEOF(x)) {
+  case LGLSXP:  return LOGICAL_RO(x);
+  case INTSXP:  return INTEGER_RO(x);
+  case REALSXP: return REAL_RO(x);
+  case CPLXSXP: return COMPLEX_RO(x);
+  case RAWSXP:  return RAW_RO(x);
+  default:      return NULL;
+  }
+}
+
+// Hashing -------------------------------------------------------------------
+// Four independent 64-bit lanes (as in xxHash) so that the main loop has no
+// cross-iteration dependency and can be pipelined or vectorised by the
+// compiler, keeping the hash close to memory bandwidth on large vectors.
+
+static const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+
+static inline
+uint64_t rotl(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline
+uint64_t hash_round(uint64_t acc, uint64_t v) {
+  return rotl(acc + v * PRIME2, 31) * PRIME1;
+}
+
+static inline
+uint64_t hash_mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+uint64_t hash_bytes(const unsigned char* data, size_t n, uint64_t seed) {
+  uint64_t acc[4] = {seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1};
+
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    uint64_t v[4];
+    std::memcpy(v, data + i, 32);
+    for (int lane = 0; lane < 4; ++lane) {
+      acc[lane] = hash_round(acc[lane], v[lane]);
+    }
+  }
+
+  uint64_t h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+  for (; i + 8 <= n; i += 8) {
+    uint64_t v;
+    std::memcpy(&v, data + i, 8);
+    h = hash_round(h, v);
+  }
+  for (; i < n; ++i) {
+    h = hash_round(h, data[i]);
+  }
+
+  return hash_mix(h ^ n);
+}
+
+uint64_t hash_vector(SEXP x) {
+  R_xlen_t n = XLENGTH(x);
+  uint64_t seed = hash_mix(TYPEOF(x) * PRIME3 + n);
+
+  // CHARSXPs live in the global string pool, so equal strings share the same
+  // address and the pointers themselves can be hashed
+  if (TYPEOF(x) == STRSXP) {
+    uint64_t h = seed;
+    for (R_xlen_t i = 0; i < n; ++i) {
+      h = hash_round(h, reinterpret_cast<uintptr_t>(STRING_ELT(x, i)));
+    }
+    return hash_mix(h);
+  }
+
+  return hash_bytes(static_cast<const unsigned char*>(payload(x)), n * element_size(x), seed);
+}
+
+bool same_contents(SEXP x, SEXP y) {
+  if (TYPEOF(x) != TYPEOF(y) || XLENGTH(x) != XLENGTH(y)) {
+    return false;
+  }
+
+  R_xlen_t n = XLENGTH(x);
+  if (TYPEOF(x) == STRSXP) {
+    for (R_xlen_t i = 0; i < n; ++i) {
+      if (STRING_ELT(x, i) != STRING_ELT(y, i))
+        return false;
+    }
+    return true;
+  }
+
+  return std::memcmp(payload(x), payload(y), n * element_size(x)) == 0;
+}
+
+// Traversal -----------------------------------------------------------------
+
+// Most ALTREP internals are metadata the user can't act on, like the start
+// and step of a compact sequence, so `_data1` and `_data2` are only followed
+// when they hold the materialised contents of the ALTREP vector itself
+static inline
+bool is_altrep_internal(SEXP x, SEXP child) {
+#if defined(R_VERSION) && R_VERSION >= R_Version(3, 5, 0)
+  if (child != R_altrep_data1(x) && child != R_altrep_data2(x)) {
+    return false;
+  }
+  return TYPEOF(child) != TYPEOF(x) || XLENGTH(child) != XLENGTH(x);
+#else
+  return false;
+#endif
+}
+
+void collect_vectors(SEXP x,
+                     SEXP base_env,
+                     std::unordered_set<SEXP>& seen,
+                     std::vector<SEXP>& out) {
+  std::vector<SEXP> stack(1, x);
+  R_xlen_t n_visited = 0;
+
+  while (!stack.empty()) {
+    SEXP cur = stack.back();
+    stack.pop_back();
+
+    if (++n_visited % 4096 == 0) {
+      cpp11::check_user_interrupt();
+    }
+
+    if (is_payload_vector(cur)) {
+      out.push_back(cur);
+    }
+
+    bool altrep = is_altrep(cur);
+    obj_edges(cur, false, [&](const EdgeLabel&, SEXP child) {
+      if (altrep && is_altrep_internal(cur, child)) {
+        return true;
+      }
+      if (TYPEOF(child) != NILSXP && TYPEOF(child) != SYMSXP && child != base_env &&
+          seen.insert(child).second) {
+        stack.push_back(child);
+      }
+      return true;
+    });
+  }
+}
+
+[[cpp11::register]]
+cpp11::list obj_dups_(cpp11::list objects, SEXP base_env, int sizeof_vector, double min_size) {
+  std::unordered_set<SEXP> seen;
+  std::vector<SEXP> vectors;
+
+  int n = objects.size();
+  for (int i = 0; i < n; ++i) {
+    SEXP x = objects[i];
+    if (seen.insert(x).second) {
+      collect_vectors(x, base_env, seen, vectors);
+    }
+  }
+
+  // Each bucket holds classes of vectors with verified identical contents;
+  // distinct classes only share a bucket on a hash collision
+  std::unordered_map<uint64_t, std::vector<std::vector<SEXP> > > buckets;
+  std::vector<std::pair<uint64_t, size_t> > order;
+
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    SEXP x = vectors[i];
+    double size = sizeof_vector + v_size(XLENGTH(x), element_size(x));
+    if (size < min_size) {
+      continue;
+    }
+    if (i % 256 == 0) {
+      cpp11::check_user_interrupt();
+    }
+
+    uint64_t hash = hash_vector(x);
+    std::vector<std::vector<SEXP> >& bucket = buckets[hash];
+
+    bool found = false;
+    for (size_t j = 0; j < bucket.size(); ++j) {
+      if (same_contents(bucket[j][0], x)) {
+        bucket[j].push_back(x);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      bucket.push_back(std::vector<SEXP>(1, x));
+      order.push_back(std::make_pair(hash, bucket.size() - 1));
+    }
+  }
+
+  cpp11::writable::strings type;
+  cpp11::writable::doubles length;
+  cpp11::writable::integers count;
+  cpp11::writable::doubles size;
+  cpp11::writable::list addrs;
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    const std::vector<SEXP>& group = buckets[order[i].first][order[i].second];
+    if (group.size() < 2) {
+      continue;
+    }
+
+    SEXP x = group[0];
+    type.push_back(Rf_type2char(TYPEOF(x)));
+    length.push_back(XLENGTH(x));
+    count.push_back(group.size());
+    size.push_back(sizeof_vector + v_size(XLENGTH(x), element_size(x)));
+
+    std::vector<std::string> group_addrs;
+    for (size_t j = 0; j < group.size(); ++j) {
+      group_addrs.push_back(obj_addr_(group[j]));
+    }
+    addrs.push_back(cpp11::as_sexp(group_addrs));
+  }
+
+  using namespace cpp11::literals;
+  return cpp11::writable::list({
+    "type"_nm = type,
+    "length"_nm = length,
+    "count"_nm = count,
+    "size"_nm = size,
+    "addrs"_nm = addrs
+  });
+}
@@ -0,0 +1,181 @@
+#include <cpp11/environment.hpp>
+#include <Rversion.h>
+#include <string>
+#include "utils.h"
+
+bool is_namespace(cpp11::environment env);
+bool is_altrep(SEXP x);
+
+static inline
+std::string index_label(R_xlen_t i) {
+  return "[[" + std::to_string(i + 1) + "]]";
+}
+
+static inline
+std::string element_label(SEXP names, R_xlen_t i) {
+  if (TYPEOF(names) == STRSXP && i < XLENGTH(names)) {
+    SEXP name = STRING_ELT(names, i);
+    if (name != NA_STRING && CHAR(name)[0] != '\0') {
+      return CHAR(name);
+    }
+  }
+  return index_label(i);
+}
+
+// Label of an edge, only formatted when a caller actually needs the string.
+// Traversals that ignore labels, like `obj_dups()`, then never allocate per
+// edge. `names` and the name must outlive the call to `visit()`.
+class EdgeLabel {
+  const char* name_;
+  SEXP names_;
+  R_xlen_t i_;
+
+public:
+  EdgeLabel(const char* name) : name_(name), names_(R_NilValue), i_(0) {
+  }
+  EdgeLabel(SEXP names, R_xlen_t i) : name_(NULL), names_(names), i_(i) {
+  }
+
+  std::string str() const {
+    return name_ != NULL ? std::string(name_) : element_label(names_, i_);
+  }
+};
+
+// Calls `visit(label, child)` for every outgoing edge of `x`, using the same
+// labels as `obj_children_()`. Unlike `sxp()`, everything that can keep an
+// object alive is followed (ALTREP data, calls, and bytecode), and unnamed
+// elements are labelled by position so that paths are unambiguous.
+//
+// `visit()` returns `false` to stop early, e.g. when a search runs out of
+// budget partway through a very wide object; `obj_edges()` then returns
+// `false` too.
+template <typename Visit>
+bool obj_edges(SEXP x, bool is_root, Visit visit) {
+  if (is_altrep(x)) {
+#if defined(R_VERSION) && R_VERSION >= R_Version(3, 5, 0)
+    if (!visit("_data1", R_altrep_data1(x))) return false;
+    if (!visit("_data2", R_altrep_data2(x))) return false;
+#endif
+  } else {
+    switch (TYPEOF(x)) {
+    // Recursive vectors
+    case VECSXP:
+    case EXPRSXP:
+    case WEAKREFSXP: {
+      SEXP names = PROTECT(Rf_getAttrib(x, R_NamesSymbol));
+      for (R_xlen_t i = 0; i < XLENGTH(x); ++i) {
+        if (!visit(EdgeLabel(names, i), VECTOR_ELT(x, i))) {
+          UNPROTECT(1);
+          return false;
+        }
+      }
+      UNPROTECT(1);
+      break;
+    }
+
+    // Linked lists
+    case LANGSXP:
+    case DOTSXP:
+    case LISTSXP: {
+      if (x == R_MissingArg) { // Needed for DOTSXP
+        break;
+      }
+
+      SEXP cons = x;
+      R_xlen_t i = 0;
+      for (; is_linked_list(cons); cons = CDR(cons), ++i) {
+        SEXP tag = TAG(cons);
+        if (TYPEOF(tag) == SYMSXP) {
+          if (!visit(CHAR(PRINTNAME(tag)), CAR(cons))) return false;
+        } else {
+          if (TYPEOF(tag) != NILSXP) {
+            if (!visit("_tag", tag)) return false;
+          }
+          if (!visit(EdgeLabel(R_NilValue, i), CAR(cons))) return false;
+        }
+      }
+      if (cons != R_NilValue) {
+        if (!visit("_cdr", cons)) return false;
+      }
+      break;
+    }
+
+    case BCODESXP:
+      if (!visit("_tag", TAG(x))) return false;
+      if (!visit("_car", CAR(x))) return false;
+      if (!visit("_cdr", CDR(x))) return false;
+      break;
+
+    // Environments
+    case ENVSXP: {
+      // Terminal environments are only searched when they're supplied as roots
+      // so that a search from a closure doesn't wander into the whole session
+      if (!is_root && (x == R_BaseEnv || x == R_GlobalEnv || x == R_EmptyEnv || is_namespace(x)))
+        break;
+
+      SEXP names = PROTECT(R_lsInternal3(x, /* all= */ TRUE, /* sorted= */ FALSE));
+      for (R_xlen_t i = 0; i < XLENGTH(names); ++i) {
+        const char* name = CHAR(STRING_ELT(names, i));
+        SEXP sym = Rf_install(name);
+
+        // Can't retrieve the function behind an active binding without
+        // calling it
+        if (R_BindingIsActive(sym, x)) {
+          continue;
+        }
+        if (!visit(name, Rf_findVarInFrame(x, sym))) {
+          UNPROTECT(1);
+          return false;
+        }
+      }
+      UNPROTECT(1);
+
+      if (x != R_EmptyEnv) {
+        if (!visit("_enclos", R_ParentEnv(x))) return false;
+      }
+      break;
+    }
+
+    // Functions
+    case CLOSXP:
+#if (R_VERSION >= R_Version(4, 5, 0))
+      if (!visit("_formals", R_ClosureFormals(x))) return false;
+      if (!visit("_body", R_ClosureBody(x))) return false;
+      if (!visit("_env", R_ClosureEnv(x))) return false;
+#else
+      if (!visit("_formals", FORMALS(x))) return false;
+      if (!visit("_body", BODY(x))) return false;
+      if (!visit("_env", CLOENV(x))) return false;
+#endif
+      break;
+
+    case PROMSXP:
+      // Using node-based object accessors: CAR for PRVALUE, CDR for PRCODE, and
+      // TAG for PRENV.
+      if (!visit("_value", CAR(x))) return false;
+      if (!visit("_code", CDR(x))) return false;
+      if (!visit("_env", TAG(x))) return false;
+      break;
+
+    case EXTPTRSXP:
+      if (!visit("_prot", R_ExternalPtrProtected(x))) return false;
+      if (!visit("_tag", R_ExternalPtrTag(x))) return false;
+      break;
+
+    case S4SXP:
+      if (!visit("_tag", TAG(x))) return false;
+      break;
+
+    // Everything else is a leaf
+    default:
+      break;
+    }
+  }
+
+  // CHARSXPs have fake attributes
+  if (TYPEOF(x) != CHARSXP && !Rf_isNull(ATTRIB(x))) {
+    return visit("_attrib", ATTRIB(x));
+  }
+
+  return true;
+}
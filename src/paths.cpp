@@ -0,0 +1,145 @@
+#include <cpp11/list.hpp>
+#include <cpp11/protect.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "edges.h"
+
+struct PathNode {
+  SEXP x;
+  R_xlen_t parent; // index into the node list, -1 for roots
+  std::string label;
+};
+
+// Leaves that can never lead to the target, so there's no point queueing them
+static inline
+bool is_path_leaf(SEXP x) {
+  switch (TYPEOF(x)) {
+  case NILSXP:
+  case SYMSXP:
+  case CHARSXP:
+  case SPECIALSXP:
+  case BUILTINSXP:
+    return true;
+  case LGLSXP:
+  case INTSXP:
+  case REALSXP:
+  case CPLXSXP:
+  case RAWSXP:
+  case STRSXP:
+    return !is_altrep(x) && Rf_isNull(ATTRIB(x));
+  default:
+    return false;
+  }
+}
+
+std::vector<std::string> path_to(const std::vector<PathNode>& nodes,
+                                 R_xlen_t i,
+                                 const std::string& label) {
+  std::vector<std::string> path;
+  path.push_back(label);
+  for (; i >= 0; i = nodes[i].parent) {
+    path.push_back(nodes[i].label);
+  }
+  return std::vector<std::string>(path.rbegin(), path.rend());
+}
+
+[[cpp11::register]]
+cpp11::list obj_paths_(cpp11::list roots,
+                       std::string addr,
+                       int max_paths,
+                       double max_nodes,
+                       double max_time) {
+  // The target is only ever compared by pointer, never dereferenced, so it's
+  // safe to search for an address that no longer points to a live object
+  SEXP target = reinterpret_cast<SEXP>(
+    static_cast<uintptr_t>(std::strtoull(addr.c_str(), NULL, 16))
+  );
+
+  std::vector<PathNode> nodes;
+  std::unordered_set<SEXP> seen;
+  std::vector<std::vector<std::string> > paths;
+
+  SEXP root_names = PROTECT(Rf_getAttrib(roots, R_NamesSymbol));
+  R_xlen_t n_roots = roots.size();
+  for (R_xlen_t i = 0; i < n_roots; ++i) {
+    SEXP root = roots[i];
+    std::string label = element_label(root_names, i);
+
+    if (root == target) {
+      if ((int) paths.size() < max_paths)
+        paths.push_back(std::vector<std::string>(1, label));
+    } else if (seen.insert(root).second) {
+      nodes.push_back({root, -1, label});
+    }
+  }
+  UNPROTECT(1);
+
+  auto start = std::chrono::steady_clock::now();
+  bool truncated = false;
+  const char* reason = NULL; // which limit stopped the search
+  R_xlen_t n_visits = 0;
+
+  // `nodes` doubles as the breadth-first queue: everything before `head` has
+  // been expanded, and parents always precede their children. Both limits are
+  // checked per edge, not per expansion, so a single very wide object (like
+  // a root environment or a long list) can't blow through them.
+  R_xlen_t head = 0;
+  for (; head < (R_xlen_t) nodes.size(); ++head) {
+    if ((int) paths.size() >= max_paths) {
+      break;
+    }
+
+    SEXP x = nodes[head].x;
+    bool complete = obj_edges(x, nodes[head].parent == -1, [&](const EdgeLabel& label, SEXP child) -> bool {
+      if (++n_visits % 1024 == 0) {
+        cpp11::check_user_interrupt();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > max_time) {
+          truncated = true;
+          reason = "time";
+          return false;
+        }
+      }
+
+      if (child == target) {
+        if ((int) paths.size() < max_paths)
+          paths.push_back(path_to(nodes, head, label.str()));
+        return (int) paths.size() < max_paths;
+      }
+      if (is_path_leaf(child) || seen.count(child)) {
+        return true;
+      }
+      if ((double) nodes.size() >= max_nodes) {
+        truncated = true;
+        reason = "nodes";
+        return false;
+      }
+
+      seen.insert(child);
+      nodes.push_back({child, head, label.str()});
+      return true;
+    });
+
+    if (!complete && truncated) {
+      break;
+    }
+  }
+
+  R_xlen_t n = paths.size();
+  SEXP out = PROTECT(Rf_allocVector(VECSXP, n));
+  for (R_xlen_t i = 0; i < n; ++i) {
+    SET_VECTOR_ELT(out, i, cpp11::as_sexp(paths[i]));
+  }
+
+  Rf_setAttrib(out, Rf_install("truncated"), PROTECT(Rf_ScalarLogical(truncated)));
+  Rf_setAttrib(out, Rf_install("reason"), PROTECT(reason == NULL ? Rf_ScalarString(NA_STRING) : Rf_mkString(reason)));
+  Rf_setAttrib(out, Rf_install("nodes"), PROTECT(Rf_ScalarReal(nodes.size())));
+  Rf_setAttrib(out, Rf_install("class"), PROTECT(Rf_mkString("lobstr_paths")));
+  UNPROTECT(5);
+
+  return out;
+}
@@ -0,0 +1,104 @@
+#include <cpp11/R.hpp>
+#include <cpp11/protect.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Output stream that counts every byte written instead of storing it.
+// Optionally it also keeps a systematic sample of fixed size blocks, spread
+// evenly over the stream, so that the compressibility of the stream can be
+// estimated without ever holding on to all of it.
+struct SerializeCounter {
+  double n;
+  double block_size;
+  double stride;
+  size_t max_sample;
+  std::vector<unsigned char> sample;
+};
+
+// Compressors need some context to be effective, so sample contiguous blocks
+const double sample_block_size = 64 * 1024;
+
+static void counter_write(SerializeCounter* counter, const unsigned char* buf, double n) {
+  double pos = counter->n;
+  double end = pos + n;
+
+  while (counter->sample.size() < counter->max_sample && pos < end) {
+    double offset = std::fmod(pos, counter->stride);
+    if (offset < counter->block_size) {
+      double len = std::min(end - pos, counter->block_size - offset);
+      size_t take = std::min((size_t) len, counter->max_sample - counter->sample.size());
+      const unsigned char* start = buf + (size_t) (pos - counter->n);
+      counter->sample.insert(counter->sample.end(), start, start + take);
+      pos += len;
+    } else {
+      pos += std::min(end - pos, counter->stride - offset);
+    }
+  }
+
+  counter->n += n;
+}
+
+static void counter_out_char(R_outpstream_t stream, int c) {
+  unsigned char byte = c;
+  counter_write(static_cast<SerializeCounter*>(stream->data), &byte, 1);
+}
+
+static void counter_out_bytes(R_outpstream_t stream, void* buf, int n) {
+  counter_write(static_cast<SerializeCounter*>(stream->data), static_cast<unsigned char*>(buf), n);
+}
+
+void serialize_to_counter(SEXP x, int version, SerializeCounter* counter) {
+  struct R_outpstream_st stream;
+  R_InitOutPStream(
+    &stream,
+    static_cast<R_pstream_data_t>(counter),
+    R_pstream_xdr_format,
+    version,
+    counter_out_char,
+    counter_out_bytes,
+    NULL,
+    R_NilValue
+  );
+  cpp11::safe[R_Serialize](x, &stream);
+}
+
+[[cpp11::register]]
+double obj_serialized_size_(SEXP x, int version) {
+  SerializeCounter counter = {0, 0, 1, 0};
+  serialize_to_counter(x, version, &counter);
+  return counter.n;
+}
+
+// `total` is the size of the complete stream, as found by
+// `obj_serialized_size_()`, and is used to space out the sampled blocks
+[[cpp11::register]]
+SEXP obj_serialized_sample_(SEXP x, int version, double total, double sample_size) {
+  SerializeCounter counter = {0, 0, 1, 0};
+
+  if (total <= sample_size) {
+    // Small enough to keep the whole stream
+    counter.block_size = counter.stride = std::max(total, 1.0);
+    counter.max_sample = total;
+  } else {
+    double block_size = std::min(sample_block_size, sample_size);
+    double n_blocks = std::ceil(sample_size / block_size);
+    counter.block_size = block_size;
+    // Keep the stride whole so every block starts on a byte boundary
+    counter.stride = std::max(std::floor(total / n_blocks), block_size);
+    counter.max_sample = sample_size;
+  }
+  counter.sample.reserve(counter.max_sample);
+
+  serialize_to_counter(x, version, &counter);
+
+  R_xlen_t n = counter.sample.size();
+  SEXP out = PROTECT(Rf_allocVector(RAWSXP, n));
+  if (n > 0) {
+    std::memcpy(RAW(out), counter.sample.data(), n);
+  }
+  UNPROTECT(1);
+
+  return out;
+}
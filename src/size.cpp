@@ -1,33 +1,65 @@
 #include <cpp11/environment.hpp>
 #include <cpp11/doubles.hpp>
 #include <cpp11/list.hpp>
+#include <cpp11/named_arg.hpp>
 #include <Rversion.h>
 #include <set>
+#include <vector>
 #include "utils.h"
 
+// Number of 8 byte words needed to store n elements
+double v_words(double n, int element_size) {
+  double vec_size = std::max(sizeof(SEXP), sizeof(double));
+  double elements_per_byte = vec_size / element_size;
+  return ceil(n / elements_per_byte);
+}
+
+// Sizes of the small vector pool classes, plus a final class for big vectors
+const int n_size_classes = 7;
+const double small_vector_sizes[n_size_classes - 1] = {8, 16, 32, 48, 64, 128};
+
+int v_size_class(double n_bytes) {
+  if      (n_bytes > 16) return 6;
+  else if (n_bytes > 8)  return 5;
+  else if (n_bytes > 6)  return 4;
+  else if (n_bytes > 4)  return 3;
+  else if (n_bytes > 2)  return 2;
+  else if (n_bytes > 1)  return 1;
+  else                   return 0;
+}
+
 [[cpp11::register]]
 double v_size(double n, int element_size) {
   if (n == 0)
     return 0;
 
-  double vec_size = std::max(sizeof(SEXP), sizeof(double));
-  double elements_per_byte = vec_size / element_size;
-  double n_bytes = ceil(n / elements_per_byte);
-  // Rcout << n << " elements, each of " << elements_per_byte << " = " <<
-  //  n_bytes << "\n";
+  double n_bytes = v_words(n, element_size);
 
-  double size = 0;
+  int size_class = v_size_class(n_bytes);
   // Big vectors always allocated in 8 byte chunks
-  if      (n_bytes > 16) size = n_bytes * 8;
+  if (size_class == n_size_classes - 1)
+    return n_bytes * 8;
   // For small vectors, round to sizes allocated in small vector pool
-  else if (n_bytes > 8)  size = 128;
-  else if (n_bytes > 6)  size = 64;
-  else if (n_bytes > 4)  size = 48;
-  else if (n_bytes > 2)  size = 32;
-  else if (n_bytes > 1)  size = 16;
-  else if (n_bytes > 0)  size = 8;
-
-  // Size is pointer to struct  + struct size
+  return small_vector_sizes[size_class];
+}
+
+// Vector data requested and allocated, broken down by size class
+struct SizeClasses {
+  double count[n_size_classes];
+  double requested[n_size_classes];
+  double allocated[n_size_classes];
+};
+
+double v_size_record(double n, int element_size, SizeClasses* classes) {
+  double size = v_size(n, element_size);
+
+  if (classes != NULL && n > 0) {
+    int size_class = v_size_class(v_words(n, element_size));
+    classes->count[size_class] += 1;
+    classes->requested[size_class] += n * element_size;
+    classes->allocated[size_class] += size;
+  }
+
   return size;
 }
 
@@ -52,6 +84,7 @@ double obj_size_tree(SEXP x,
                      int sizeof_node,
                      int sizeof_vector,
                      std::set<SEXP>& seen,
+                     SizeClasses* classes,
                      int depth) {
   // NILSXP is a singleton, so occupies no space. Similarly SPECIAL and
   // BUILTIN are fixed and unchanging
@@ -75,16 +108,16 @@ double obj_size_tree(SEXP x,
     SEXP klass = ALTREP_CLASS(x);
 
     size += 3 * sizeof(SEXP);
-    size += obj_size_tree(klass, base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(R_altrep_data1(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(R_altrep_data2(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(klass, base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(R_altrep_data1(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(R_altrep_data2(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     return size;
   }
 #endif
 
   // CHARSXPs have fake attributes
   if (TYPEOF(x) != CHARSXP )
-    size += obj_size_tree(ATTRIB(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(ATTRIB(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
 
   switch (TYPEOF(x)) {
   // Vectors -------------------------------------------------------------------
@@ -93,37 +126,37 @@ double obj_size_tree(SEXP x,
   // Simple vectors
   case LGLSXP:
   case INTSXP:
-    size += v_size(XLENGTH(x), sizeof(int));
+    size += v_size_record(XLENGTH(x), sizeof(int), classes);
     break;
   case REALSXP:
-    size += v_size(XLENGTH(x), sizeof(double));
+    size += v_size_record(XLENGTH(x), sizeof(double), classes);
     break;
   case CPLXSXP:
-    size += v_size(XLENGTH(x), sizeof(Rcomplex));
+    size += v_size_record(XLENGTH(x), sizeof(Rcomplex), classes);
     break;
   case RAWSXP:
-    size += v_size(XLENGTH(x), 1);
+    size += v_size_record(XLENGTH(x), 1, classes);
     break;
 
   // Strings
   case STRSXP:
-    size += v_size(XLENGTH(x), sizeof(SEXP));
+    size += v_size_record(XLENGTH(x), sizeof(SEXP), classes);
     for (R_xlen_t i = 0; i < XLENGTH(x); i++) {
-      size += obj_size_tree(STRING_ELT(x, i), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+      size += obj_size_tree(STRING_ELT(x, i), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     }
     break;
 
   case CHARSXP:
-    size += v_size(LENGTH(x) + 1, 1);
+    size += v_size_record(LENGTH(x) + 1, 1, classes);
     break;
 
   // Generic vectors
   case VECSXP:
   case EXPRSXP:
   case WEAKREFSXP:
-    size += v_size(XLENGTH(x), sizeof(SEXP));
+    size += v_size_record(XLENGTH(x), sizeof(SEXP), classes);
     for (R_xlen_t i = 0; i < XLENGTH(x); ++i) {
-      size += obj_size_tree(VECTOR_ELT(x, i), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+      size += obj_size_tree(VECTOR_ELT(x, i), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     }
     break;
 
@@ -144,19 +177,19 @@ double obj_size_tree(SEXP x,
       if (cons != x) {
         size += sizeof_node;
       }
-      size += obj_size_tree(TAG(cons), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-      size += obj_size_tree(CAR(cons), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+      size += obj_size_tree(TAG(cons), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+      size += obj_size_tree(CAR(cons), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     }
     // Handle non-nil CDRs
-    size += obj_size_tree(cons, base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(cons, base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
 
     break;
   }
 
   case BCODESXP:
-    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(CAR(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(CDR(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(CAR(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(CDR(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     break;
 
   // Environments
@@ -170,23 +203,23 @@ double obj_size_tree(SEXP x,
     // the sizes of contained elements. Unfortunately this means we'll have to
     // infer the size of the hash table frame itself using heuristics.
     size += obj_size_tree(CAR(x), base_env, sizeof_node, sizeof_vector, seen,
-    depth + 1);
-    size += obj_size_tree(R_ParentEnv(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    classes, depth + 1);
+    size += obj_size_tree(R_ParentEnv(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     break;
 
   // Functions
   case CLOSXP:
 #if (R_VERSION >= R_Version(4, 5, 0))
-    size += obj_size_tree(R_ClosureFormals(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(R_ClosureFormals(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     // R_ClosureBody/BODY is either a bare expression or a byte code that wraps
     // the expression along with other data.
-    size += obj_size_tree(R_ClosureBody(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(R_ClosureEnv(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(R_ClosureBody(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(R_ClosureEnv(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
 #else
-    size += obj_size_tree(FORMALS(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(BODY(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(CLOENV(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(FORMALS(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(BODY(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(CLOENV(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
 #endif
     break;
 
@@ -194,19 +227,19 @@ double obj_size_tree(SEXP x,
     // Using node-based object accessors: CAR for PRVALUE, CDR for PRCODE, and
     // TAG for PRENV. TODO: Iterate manually over the environment using
     // environment accessors.
-    size += obj_size_tree(CAR(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(CDR(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(CAR(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(CDR(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     break;
 
   case EXTPTRSXP:
     size += sizeof(void *); // the actual pointer
-    size += obj_size_tree(R_ExternalPtrProtected(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
-    size += obj_size_tree(R_ExternalPtrTag(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(R_ExternalPtrProtected(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
+    size += obj_size_tree(R_ExternalPtrTag(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     break;
 
   case S4SXP:
-    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, depth + 1);
+    size += obj_size_tree(TAG(x), base_env, sizeof_node, sizeof_vector, seen, classes, depth + 1);
     break;
 
   case SYMSXP:
@@ -227,7 +260,7 @@ double obj_size_(cpp11::list objects, cpp11::environment base_env, int sizeof_no
 
   int n = objects.size();
   for (int i = 0; i < n; ++i) {
-    size += obj_size_tree(objects[i], base_env, sizeof_node, sizeof_vector, seen, 0);
+    size += obj_size_tree(objects[i], base_env, sizeof_node, sizeof_vector, seen, NULL, 0);
   }
 
   return size;
@@ -240,8 +273,26 @@ cpp11::doubles obj_csize_(cpp11::list objects, cpp11::environment base_env, int
 
   cpp11::writable::doubles out(n);
   for (int i = 0; i < n; ++i) {
-    out[i] = obj_size_tree(objects[i], base_env, sizeof_node, sizeof_vector, seen, 0);
+    out[i] = obj_size_tree(objects[i], base_env, sizeof_node, sizeof_vector, seen, NULL, 0);
   }
 
   return out;
 }
+
+[[cpp11::register]]
+cpp11::list obj_size_classes_(cpp11::list objects, cpp11::environment base_env, int sizeof_node, int sizeof_vector) {
+  std::set<SEXP> seen;
+  SizeClasses classes = {};
+
+  int n = objects.size();
+  for (int i = 0; i < n; ++i) {
+    obj_size_tree(objects[i], base_env, sizeof_node, sizeof_vector, seen, &classes, 0);
+  }
+
+  using namespace cpp11::literals;
+  return cpp11::writable::list({
+    "count"_nm = std::vector<double>(classes.count, classes.count + n_size_classes),
+    "requested"_nm = std::vector<double>(classes.requested, classes.requested + n_size_classes),
+    "allocated"_nm = std::vector<double>(classes.allocated, classes.allocated + n_size_classes)
+  });
+}